@@ -0,0 +1,270 @@
+"""
+End-to-end benchmark of your SpamDetector against the school's, on generated databases and messages.
+
+Run it from the terminal, for example:
+  `python3 bench.py`
+  `python3 bench.py --db-sizes 10 1000 100000 --message-sizes 1K 1M 64M --hit-rate 0.05`
+
+For every combination of DB size and message size, both executables are ran on the same inputs, and the wall time,
+peak RSS(max resident set size) and throughput are reported. The outputs of both executables are also compared, so a
+faster but incorrect implementation doesn't go unnoticed.
+Note that the generated messages can be large(up to the biggest message size), they're written to a temporary directory
+unless `--work-dir` is given, in which case they're reused between runs.
+"""
+from __future__ import annotations
+import argparse
+import ctypes
+import os
+import random
+import signal
+import subprocess
+import sys
+import time
+from dataclasses import dataclass
+from pathlib import Path
+from tempfile import TemporaryDirectory
+from typing import List, Optional
+
+TEST_DIR = Path(__file__).parent
+
+EXECUTABLE_PATH = Path(Path(TEST_DIR) / "../cmake-build-debug/SpamDetector")
+SCHOOL_EXECUTABLE = Path(Path(TEST_DIR) / "./SchoolSpamDetector")
+
+# phrases are made of the letters a-m, and the filler text of the letters n-z, so the filler never contains a phrase
+PHRASE_LETTERS = "abcdefghijklm"
+FILLER_LETTERS = "nopqrstuvwxyz"
+
+SIZE_SUFFIXES = {"K": 1024, "M": 1024 ** 2, "G": 1024 ** 3}
+
+
+def parse_size(size: str) -> int:
+    """
+    Parses a size such as "512", "1K", "16M" or "1G" into a number of bytes
+    """
+    size = size.strip().upper()
+    if size and size[-1] in SIZE_SUFFIXES:
+        return int(size[:-1]) * SIZE_SUFFIXES[size[-1]]
+    return int(size)
+
+
+def format_size(size: int) -> str:
+    for suffix, factor in reversed(list(SIZE_SUFFIXES.items())):
+        if size >= factor and size % factor == 0:
+            return f"{size // factor}{suffix}"
+    return str(size)
+
+
+def random_word(rng: random.Random, letters: str) -> str:
+    return "".join(rng.choice(letters) for _ in range(rng.randint(3, 10)))
+
+
+def generate_db(path: Path, phrase_count: int, seed: int = 1337) -> List[str]:
+    """
+    Writes a valid DB with the given number of distinct phrases(of 1 to 3 words), returning the phrases
+    """
+    rng = random.Random(seed)
+    phrases = set()
+    while len(phrases) < phrase_count:
+        phrases.add(" ".join(random_word(rng, PHRASE_LETTERS) for _ in range(rng.randint(1, 3))))
+    phrases = sorted(phrases)
+    rng.shuffle(phrases)
+    with open(path, "w") as db:
+        for phrase in phrases:
+            db.write(f"{phrase},{rng.randint(0, 100)}\n")
+    return phrases
+
+
+def generate_message(path: Path, size: int, phrases: List[str], hit_rate: float, seed: int = 1337):
+    """
+    Writes a message of (about) the given size in bytes, where roughly 'hit_rate' of the words are DB phrases
+    """
+    rng = random.Random(seed)
+    # generating a pool of lines once and sampling it, since generating 1GB word by word would take forever
+    lines = []
+    for _ in range(1000):
+        words = [rng.choice(phrases) if rng.random() < hit_rate else random_word(rng, FILLER_LETTERS)
+                 for _ in range(rng.randint(5, 15))]
+        lines.append(" ".join(words) + "\n")
+    written = 0
+    with open(path, "w") as message:
+        while written < size:
+            chunk = "".join(rng.choices(lines, k=1000))[:size - written]
+            message.write(chunk)
+            written += len(chunk)
+
+
+@dataclass
+class Measurement:
+    return_code: int
+    stdout: str
+    stderr: str
+    wall_time: float
+    cpu_time: float
+    # in kilobytes, None if it couldn't be measured(see measure())
+    max_rss: Optional[int]
+
+
+# ptrace(2) requests and options, used to stop the measured process right before it exits (see measure())
+PTRACE_TRACEME = 0
+PTRACE_CONT = 7
+PTRACE_SETOPTIONS = 0x4200
+PTRACE_O_TRACEEXEC = 0x10
+PTRACE_O_TRACEEXIT = 0x40
+PTRACE_O_EXITKILL = 0x100000
+PTRACE_EVENT_EXEC = 4
+PTRACE_EVENT_EXIT = 6
+
+
+def _load_libc():
+    if not sys.platform.startswith("linux"):
+        return None
+    try:
+        libc = ctypes.CDLL(None, use_errno=True)
+    except OSError:
+        return None
+    libc.ptrace.argtypes = [ctypes.c_long, ctypes.c_long, ctypes.c_void_p, ctypes.c_void_p]
+    libc.ptrace.restype = ctypes.c_long
+    return libc
+
+
+_LIBC = _load_libc()
+
+
+def _read_peak_rss(pid: int) -> Optional[int]:
+    """
+    Returns the peak RSS(VmHWM, in kilobytes) of a process, or None if it's unavailable
+    """
+    try:
+        with open(f"/proc/{pid}/status") as status:
+            for line in status:
+                if line.startswith("VmHWM:"):
+                    return int(line.split()[1])
+    except OSError:
+        pass
+    return None
+
+
+def measure(command_list: List[str]) -> Measurement:
+    """
+    Executes the given command list, measuring its wall time, CPU time(user + system) and peak RSS
+    """
+    # The rusage's ru_maxrss of a child also counts the memory of this (python) process, which the child was forked
+    # from before exec-ing, and sampling /proc while the child runs misses most of a short run. Instead, the child is
+    # traced(on Linux) so that it stops right before exiting, while its memory still exists, and its VmHWM(the peak
+    # RSS since the exec) is read then. If tracing isn't possible, the peak RSS is unknown(None) rather than wrong.
+    trace = _LIBC is not None
+    with TemporaryDirectory() as out_dir:
+        stdout_path, stderr_path = Path(out_dir) / "stdout", Path(out_dir) / "stderr"
+        with open(stdout_path, "w") as stdout, open(stderr_path, "w") as stderr:
+            start = time.perf_counter()
+            process = subprocess.Popen(command_list, stdout=stdout, stderr=stderr,
+                                       preexec_fn=(lambda: _LIBC.ptrace(PTRACE_TRACEME, 0, None, None))
+                                       if trace else None)
+            peak_rss = None
+            exec_stopped = False
+            try:
+                while True:
+                    # os.wait4 gives us the resource usage(CPU time) of this specific child
+                    pid, status, usage = os.wait4(process.pid, 0)
+                    if not os.WIFSTOPPED(status):
+                        break
+                    signal_to_deliver = 0
+                    if os.WSTOPSIG(status) == signal.SIGTRAP and status >> 16 == PTRACE_EVENT_EXIT:
+                        peak_rss = _read_peak_rss(process.pid)
+                    elif os.WSTOPSIG(status) == signal.SIGTRAP and status >> 16 == PTRACE_EVENT_EXEC:
+                        # the program exec-ed another one(e.g, a wrapper script), which just keeps running
+                        pass
+                    elif os.WSTOPSIG(status) == signal.SIGTRAP and not exec_stopped:
+                        # the stop after the first exec, from now on stop only before exiting(and on further execs,
+                        # which would otherwise send the child a SIGTRAP)
+                        exec_stopped = True
+                        _LIBC.ptrace(PTRACE_SETOPTIONS, process.pid, None,
+                                     ctypes.c_void_p(PTRACE_O_TRACEEXEC | PTRACE_O_TRACEEXIT | PTRACE_O_EXITKILL))
+                    else:
+                        # any other signal is passed on to the child as if it wasn't traced
+                        signal_to_deliver = os.WSTOPSIG(status)
+                    _LIBC.ptrace(PTRACE_CONT, process.pid, None, ctypes.c_void_p(signal_to_deliver))
+            except KeyboardInterrupt:
+                process.kill()
+                raise
+            wall_time = time.perf_counter() - start
+            # a negative return code means the process was killed by a signal, as in 'subprocess'
+            process.returncode = os.WEXITSTATUS(status) if os.WIFEXITED(status) else -os.WTERMSIG(status)
+        return Measurement(process.returncode, stdout_path.read_text(), stderr_path.read_text(), wall_time,
+                           usage.ru_utime + usage.ru_stime, peak_rss)
+
+
+def format_rss(max_rss: Optional[int]) -> str:
+    return f"{max_rss / 1024:.1f}MB" if max_rss is not None else "unknown"
+
+
+def report(label: str, measurement: Measurement, message_size: int):
+    throughput = message_size / (1024 ** 2) / measurement.wall_time if measurement.wall_time > 0 else float("inf")
+    print(f"  {label:<8} wall={measurement.wall_time:9.3f}s  cpu={measurement.cpu_time:9.3f}s  "
+          f"maxRSS={format_rss(measurement.max_rss):>10}  {throughput:10.2f}MB/s  "
+          f"{1 / measurement.wall_time if measurement.wall_time > 0 else float('inf'):10.2f}messages/s")
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--db-sizes", nargs="+", type=int, default=[10, 1000, 10000],
+                        help="numbers of phrases in the generated DBs (e.g 10 .. 10000000)")
+    parser.add_argument("--message-sizes", nargs="+", type=parse_size, default=[parse_size("1K"), parse_size("1M")],
+                        help="sizes of the generated messages (e.g 1K .. 1G)")
+    parser.add_argument("--hit-rate", type=float, default=0.01,
+                        help="fraction of the message's words that are DB phrases")
+    parser.add_argument("--threshold", type=int, default=1000)
+    parser.add_argument("--work-dir", type=Path, default=None,
+                        help="where to keep the generated files(reused if they exist), a temporary dir by default")
+    parser.add_argument("--no-school", action="store_true", help="only run your executable")
+    args = parser.parse_args()
+
+    if not EXECUTABLE_PATH.exists():
+        print(f"Couldn't find your executable at {EXECUTABLE_PATH}", file=sys.stderr)
+        return -1
+    if not args.no_school and not SCHOOL_EXECUTABLE.exists():
+        print(f"Couldn't find school executable at {SCHOOL_EXECUTABLE}", file=sys.stderr)
+        return -1
+
+    temp_dir = None
+    if args.work_dir is None:
+        temp_dir = TemporaryDirectory()
+        args.work_dir = Path(temp_dir.name)
+    args.work_dir.mkdir(parents=True, exist_ok=True)
+
+    mismatches = 0
+    try:
+        for db_size in args.db_sizes:
+            db_path = args.work_dir / f"bench_{db_size}.db"
+            phrases = generate_db(db_path, db_size)
+            for message_size in args.message_sizes:
+                message_path = args.work_dir / f"bench_{db_size}_{format_size(message_size)}_{args.hit_rate}.txt"
+                if not message_path.exists():
+                    generate_message(message_path, message_size, phrases, args.hit_rate)
+
+                print(f"DB of {db_size} phrases, message of {format_size(message_size)} bytes, "
+                      f"hit rate {args.hit_rate}")
+                command = [str(db_path), str(message_path), str(args.threshold)]
+                mine = measure([str(EXECUTABLE_PATH)] + command)
+                report("yours", mine, message_size)
+                if args.no_school:
+                    continue
+                school = measure([str(SCHOOL_EXECUTABLE)] + command)
+                report("school", school, message_size)
+                if (mine.return_code, mine.stdout, mine.stderr) != (school.return_code, school.stdout, school.stderr):
+                    mismatches += 1
+                    print(f"  MISMATCH: school printed {school.stdout.strip() or school.stderr.strip()!r}, "
+                          f"yours printed {mine.stdout.strip() or mine.stderr.strip()!r}")
+                else:
+                    rss_ratio = "unknown" if mine.max_rss is None or school.max_rss is None else \
+                        f"{mine.max_rss / max(school.max_rss, 1):.2f}x"
+                    print(f"  ratio(yours/school): wall={mine.wall_time / max(school.wall_time, 1e-9):.2f}x  "
+                          f"maxRSS={rss_ratio}")
+    finally:
+        if temp_dir is not None:
+            temp_dir.cleanup()
+    return 1 if mismatches else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
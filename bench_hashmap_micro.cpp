@@ -0,0 +1,330 @@
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch.hpp"
+#include "../HashMap.hpp"
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+/*
+ * Microbenchmarks of every HashMap operation used by test_hashmap, for int and std::string keys at several sizes, each
+ * one next to the same operation on a std::unordered_map as a baseline.
+ *
+ * Compile in release mode, and run e.g:
+ *   bench_hashmap_micro                          (all benchmarks)
+ *   bench_hashmap_micro "[insert]"               (only a single operation)
+ *   bench_hashmap_micro --benchmark-samples 20   (faster, less accurate)
+ * Catch reports the mean time per run along with its standard deviation, so results of different builds (or different
+ * implementations) can be compared directly.
+ */
+
+namespace
+{
+    const std::vector<int> SIZES{1000, 100000};
+
+    std::vector<int> makeKeys(int count, int)
+    {
+        std::vector<int> keys(count);
+        std::iota(keys.begin(), keys.end(), 0);
+        std::shuffle(keys.begin(), keys.end(), std::mt19937(1337));
+        return keys;
+    }
+
+    std::vector<std::string> makeKeys(int count, const std::string&)
+    {
+        std::vector<std::string> keys;
+        for (int key: makeKeys(count, 0))
+        {
+            // long enough to not fit in the small string optimization
+            keys.push_back("a rather long phrase number " + std::to_string(key));
+        }
+        return keys;
+    }
+
+    // adapters for the operations whose signatures differ between HashMap and std::unordered_map
+
+    template <typename KeyT, typename ValueT>
+    bool insert(HashMap<KeyT, ValueT>& map, const KeyT& key, const ValueT& value)
+    {
+        return map.insert(key, value);
+    }
+
+    template <typename KeyT, typename ValueT>
+    bool insert(std::unordered_map<KeyT, ValueT>& map, const KeyT& key, const ValueT& value)
+    {
+        return map.emplace(key, value).second;
+    }
+
+    template <typename KeyT, typename ValueT>
+    bool contains(const HashMap<KeyT, ValueT>& map, const KeyT& key)
+    {
+        return map.containsKey(key);
+    }
+
+    template <typename KeyT, typename ValueT>
+    bool contains(const std::unordered_map<KeyT, ValueT>& map, const KeyT& key)
+    {
+        return map.count(key) == 1;
+    }
+
+    template <typename KeyT, typename ValueT>
+    HashMap<KeyT, ValueT> fromVectors(const std::vector<KeyT>& keys, const std::vector<ValueT>& values,
+                                      const HashMap<KeyT, ValueT>*)
+    {
+        return HashMap<KeyT, ValueT>(keys, values);
+    }
+
+    template <typename KeyT, typename ValueT>
+    std::unordered_map<KeyT, ValueT> fromVectors(const std::vector<KeyT>& keys, const std::vector<ValueT>& values,
+                                                 const std::unordered_map<KeyT, ValueT>*)
+    {
+        std::unordered_map<KeyT, ValueT> map;
+        for (size_t i = 0; i < keys.size(); ++i)
+        {
+            map[keys[i]] = values[i];
+        }
+        return map;
+    }
+
+    /**
+     * Registers the benchmarks of a single operation for a map type, for every size in SIZES.
+     * 'run' receives the Catch chronometer, the keys, and a map holding all of them (with values 0..size-1).
+     */
+    template <typename Map, typename Run>
+    void benchmarkOperation(const std::string& mapName, Run run)
+    {
+        using KeyT = typename std::decay<decltype(std::declval<Map>().begin()->first)>::type;
+        for (int size: SIZES)
+        {
+            std::vector<KeyT> keys = makeKeys(size, KeyT());
+            std::vector<int> values(size);
+            std::iota(values.begin(), values.end(), 0);
+            const Map full = fromVectors(keys, values, static_cast<const Map*>(nullptr));
+
+            BENCHMARK_ADVANCED(mapName + " n=" + std::to_string(size))(Catch::Benchmark::Chronometer meter)
+            {
+                run(meter, keys, values, full);
+            };
+        }
+    }
+
+    template <typename Run>
+    void benchmarkAll(Run run)
+    {
+        benchmarkOperation<HashMap<int, int>>("HashMap<int,int>", run);
+        benchmarkOperation<std::unordered_map<int, int>>("std::unordered_map<int,int>", run);
+        benchmarkOperation<HashMap<std::string, int>>("HashMap<string,int>", run);
+        benchmarkOperation<std::unordered_map<std::string, int>>("std::unordered_map<string,int>", run);
+    }
+}
+
+TEST_CASE("Default construction", "[construct]")
+{
+    BENCHMARK("HashMap<int,int>")
+    {
+        return HashMap<int, int>();
+    };
+    BENCHMARK("std::unordered_map<int,int>")
+    {
+        return std::unordered_map<int, int>();
+    };
+    BENCHMARK("HashMap<string,int>")
+    {
+        return HashMap<std::string, int>();
+    };
+    BENCHMARK("std::unordered_map<string,int>")
+    {
+        return std::unordered_map<std::string, int>();
+    };
+}
+
+TEST_CASE("Vectors constructor", "[construct]")
+{
+    benchmarkAll([](Catch::Benchmark::Chronometer meter, const auto& keys, const std::vector<int>& values,
+                    const auto& full) {
+        using Map = typename std::decay<decltype(full)>::type;
+        meter.measure([&] { return fromVectors(keys, values, static_cast<const Map*>(nullptr)); });
+    });
+}
+
+TEST_CASE("Copy constructor", "[copy]")
+{
+    benchmarkAll([](Catch::Benchmark::Chronometer meter, const auto&, const std::vector<int>&, const auto& full) {
+        using Map = typename std::decay<decltype(full)>::type;
+        meter.measure([&] { return Map(full); });
+    });
+}
+
+TEST_CASE("Copy assignment", "[copy]")
+{
+    benchmarkAll([](Catch::Benchmark::Chronometer meter, const auto& keys, const std::vector<int>& values,
+                    const auto& full) {
+        using Map = typename std::decay<decltype(full)>::type;
+        using Keys = typename std::decay<decltype(keys)>::type;
+        // assigning into maps which already hold a few entries, so their old storage has to be released
+        const Map small = fromVectors(Keys(keys.begin(), keys.begin() + 10),
+                                      std::vector<int>(values.begin(), values.begin() + 10),
+                                      static_cast<const Map*>(nullptr));
+        std::vector<Map> maps(meter.runs(), small);
+        meter.measure([&](int run) {
+            maps[run] = full;
+            return maps[run].size();
+        });
+    });
+}
+
+TEST_CASE("Equality of equal maps", "[equality]")
+{
+    benchmarkAll([](Catch::Benchmark::Chronometer meter, const auto&, const std::vector<int>&, const auto& full) {
+        using Map = typename std::decay<decltype(full)>::type;
+        const Map copy(full);
+        meter.measure([&] { return full == copy; });
+    });
+}
+
+TEST_CASE("Insert", "[insert]")
+{
+    benchmarkAll([](Catch::Benchmark::Chronometer meter, const auto& keys, const std::vector<int>& values,
+                    const auto& full) {
+        using Map = typename std::decay<decltype(full)>::type;
+        meter.measure([&] {
+            Map map;
+            for (size_t i = 0; i < keys.size(); ++i)
+            {
+                insert(map, keys[i], values[i]);
+            }
+            return map;
+        });
+    });
+}
+
+TEST_CASE("operator[] on existing keys", "[subscript]")
+{
+    benchmarkAll([](Catch::Benchmark::Chronometer meter, const auto& keys, const std::vector<int>&,
+                    const auto& full) {
+        using Map = typename std::decay<decltype(full)>::type;
+        Map map(full);
+        meter.measure([&] {
+            long sum = 0;
+            for (const auto& key: keys)
+            {
+                sum += map[key];
+            }
+            return sum;
+        });
+    });
+}
+
+TEST_CASE("at on existing keys", "[at]")
+{
+    benchmarkAll([](Catch::Benchmark::Chronometer meter, const auto& keys, const std::vector<int>&,
+                    const auto& full) {
+        meter.measure([&] {
+            long sum = 0;
+            for (const auto& key: keys)
+            {
+                sum += full.at(key);
+            }
+            return sum;
+        });
+    });
+}
+
+TEST_CASE("containsKey on present and missing keys", "[contains]")
+{
+    benchmarkAll([](Catch::Benchmark::Chronometer meter, const auto& keys, const std::vector<int>&,
+                    const auto& full) {
+        using Map = typename std::decay<decltype(full)>::type;
+        // a map holding only every other key, so half of the lookups miss
+        Map half;
+        for (size_t i = 0; i < keys.size(); i += 2)
+        {
+            half[keys[i]] = 0;
+        }
+        meter.measure([&] {
+            int found = 0;
+            for (const auto& key: keys)
+            {
+                found += contains(half, key);
+            }
+            return found;
+        });
+    });
+}
+
+TEST_CASE("Erase all keys", "[erase]")
+{
+    benchmarkAll([](Catch::Benchmark::Chronometer meter, const auto& keys, const std::vector<int>&,
+                    const auto& full) {
+        using Map = typename std::decay<decltype(full)>::type;
+        // every run gets a fresh copy of the full map, and only the erasing is measured
+        std::vector<Map> maps(meter.runs(), full);
+        meter.measure([&](int run) {
+            for (const auto& key: keys)
+            {
+                maps[run].erase(key);
+            }
+            return maps[run].size();
+        });
+    });
+}
+
+TEST_CASE("Clear", "[clear]")
+{
+    benchmarkAll([](Catch::Benchmark::Chronometer meter, const auto&, const std::vector<int>&, const auto& full) {
+        using Map = typename std::decay<decltype(full)>::type;
+        std::vector<Map> maps(meter.runs(), full);
+        meter.measure([&](int run) {
+            maps[run].clear();
+            return maps[run].size();
+        });
+    });
+}
+
+TEST_CASE("Iteration", "[iteration]")
+{
+    benchmarkAll([](Catch::Benchmark::Chronometer meter, const auto&, const std::vector<int>&, const auto& full) {
+        meter.measure([&] {
+            long sum = 0;
+            for (const auto& kvp: full)
+            {
+                sum += kvp.second;
+            }
+            return sum;
+        });
+    });
+}
+
+TEST_CASE("The 1M insertions workload of test_hashmap", "[large]")
+{
+    // like "Behaves similarly to a std::unordered_map": 1M random assignments of keys between 0 and 100k
+    std::mt19937 rng(1337);
+    std::uniform_int_distribution<int> intGen(0, 100000);
+    std::vector<std::pair<int, int>> assignments;
+    for (int i = 0; i < 1000000; ++i)
+    {
+        int key = intGen(rng);
+        assignments.emplace_back(key, intGen(rng));
+    }
+
+    BENCHMARK("HashMap<int,int>")
+    {
+        HashMap<int, int> map;
+        for (const auto& assignment: assignments)
+        {
+            map[assignment.first] = assignment.second;
+        }
+        return map.size();
+    };
+    BENCHMARK("std::unordered_map<int,int>")
+    {
+        std::unordered_map<int, int> map;
+        for (const auto& assignment: assignments)
+        {
+            map[assignment.first] = assignment.second;
+        }
+        return map.size();
+    };
+}
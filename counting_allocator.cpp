@@ -0,0 +1,45 @@
+#include <cstdlib>
+#include <new>
+
+/*
+ * Replacements of the global operator new/delete counting the allocations, used by test_hashmap_alloc.
+ * They're kept in their own translation unit, so the compiler can't inline them into the tests and then warn about (or
+ * "optimize") the malloc/free pairs it sees behind new/delete.
+ */
+
+long allocationCount = 0;
+
+void* operator new(std::size_t size)
+{
+    ++allocationCount;
+    if (void* ptr = std::malloc(size == 0 ? 1 : size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
@@ -2,9 +2,146 @@
 #include "catch.hpp"
 #include "../HashMap.hpp"
 #include <set>
+#include <climits>
+#include <map>
 #include <random>
+#include <chrono>
+#include <sstream>
+#include <numeric>
+#include <functional>
+#include <algorithm>
+#include <thread>
+#include <type_traits>
+#include <iterator>
 #include <unordered_map>
 
+/**
+ * Statistics about the bucket layout of a map, gathered only via the public API (bucketIndex, bucketSize, capacity,
+ * getLoadFactor), so they work for any implementation. Useful for diagnosing a bad hash function or resize policy
+ * without attaching a profiler.
+ */
+struct BucketStats
+{
+    int capacity = 0;
+    int size = 0;
+    double loadFactor = 0;
+    int occupiedBuckets = 0;
+    // length of the longest bucket(chain)
+    int maxChainLength = 0;
+    // average length of a non-empty bucket
+    double meanChainLength = 0;
+    // average number of entries in the bucket of a key, over all keys in the map (i.e, the expected cost of a lookup)
+    double meanProbeLength = 0;
+    // maps a chain length to the number of buckets having that length (empty buckets are counted under 0)
+    std::map<int, int> histogram;
+};
+
+template <typename KeyT, typename ValueT>
+BucketStats collectBucketStats(const HashMap<KeyT, ValueT>& map)
+{
+    BucketStats stats;
+    stats.capacity = map.capacity();
+    stats.size = map.size();
+    stats.loadFactor = map.getLoadFactor();
+
+    std::map<int, int> chainLengths;
+    long totalProbe = 0;
+    for (const auto& kvp: map)
+    {
+        int bucketSize = map.bucketSize(kvp.first);
+        chainLengths[map.bucketIndex(kvp.first)] = bucketSize;
+        totalProbe += bucketSize;
+    }
+
+    stats.occupiedBuckets = chainLengths.size();
+    stats.histogram[0] = stats.capacity - stats.occupiedBuckets;
+    for (const auto& bucket: chainLengths)
+    {
+        stats.maxChainLength = std::max(stats.maxChainLength, bucket.second);
+        ++stats.histogram[bucket.second];
+    }
+    if (stats.occupiedBuckets > 0)
+    {
+        stats.meanChainLength = static_cast<double>(stats.size) / stats.occupiedBuckets;
+        stats.meanProbeLength = static_cast<double>(totalProbe) / stats.size;
+    }
+    return stats;
+}
+
+std::ostream& operator<<(std::ostream& os, const BucketStats& stats)
+{
+    os << "size=" << stats.size << " capacity=" << stats.capacity << " loadFactor=" << stats.loadFactor
+       << " occupiedBuckets=" << stats.occupiedBuckets << " maxChain=" << stats.maxChainLength
+       << " meanChain=" << stats.meanChainLength << " meanProbe=" << stats.meanProbeLength << "\nhistogram:";
+    for (const auto& entry: stats.histogram)
+    {
+        os << " " << entry.first << ":" << entry.second;
+    }
+    return os;
+}
+
+/**
+ * Inserts the given keys one after another, counting how many times the capacity changed(resizes) and how long
+ * those particular insertions took(which is mostly the rehashing time).
+ */
+template <typename KeyT, typename ValueT>
+void insertTrackingResizes(HashMap<KeyT, ValueT>& map, const std::vector<KeyT>& keys, int& resizes,
+                           std::chrono::duration<double, std::milli>& rehashTime)
+{
+    for (const KeyT& key: keys)
+    {
+        int oldCapacity = map.capacity();
+        auto start = std::chrono::steady_clock::now();
+        map[key] = ValueT();
+        auto end = std::chrono::steady_clock::now();
+        if (map.capacity() != oldCapacity)
+        {
+            ++resizes;
+            rehashTime += end - start;
+        }
+    }
+}
+
+/**
+ * Reduces a (const) map using several threads: [begin, end) is split into contiguous sub-ranges of roughly equal
+ * length, each one is reduced on its own thread with 'op' starting from 'identity', and the partial results are then
+ * merged in order with 'combine', again starting from 'identity'. Since it only uses the forward iterator, it works for
+ * any implementation. The result is the same as std::accumulate(begin, end, identity, op) as long as 'combine' is
+ * associative, 'identity' is its identity element, and op(combine(x, y), kvp) == combine(x, op(y, kvp)) (e.g, a sum
+ * with op adding a value and combine adding two sums).
+ */
+template <typename KeyT, typename ValueT, typename T, typename BinaryOp, typename CombineOp>
+T parallelAccumulate(const HashMap<KeyT, ValueT>& map, int threadCount, T identity, BinaryOp op, CombineOp combine)
+{
+    using Iterator = decltype(map.begin());
+    std::vector<Iterator> bounds{map.begin()};
+    int chunkSize = (map.size() + threadCount - 1) / threadCount;
+    for (int i = 1; i < threadCount; ++i)
+    {
+        Iterator next = bounds.back();
+        for (int j = 0; j < chunkSize && next != map.end(); ++j)
+        {
+            ++next;
+        }
+        bounds.push_back(next);
+    }
+    bounds.push_back(map.end());
+
+    std::vector<T> partials(threadCount, identity);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadCount; ++i)
+    {
+        threads.emplace_back([&, i]() {
+            partials[i] = std::accumulate(bounds[i], bounds[i + 1], identity, op);
+        });
+    }
+    for (std::thread& thread: threads)
+    {
+        thread.join();
+    }
+    return std::accumulate(partials.begin(), partials.end(), identity, combine);
+}
+
 TEST_CASE("Sanity check, ensure you configured the tests correctly") {
     REQUIRE(1 + 1 == 2);
 }
@@ -176,6 +313,91 @@ TEST_CASE("Basic HashMap tests") {
 
 }
 
+/**
+ * A value type that isn't trivially copyable, counting how many instances of it are alive, so we can tell whether the
+ * map constructs and destroys its values properly.
+ */
+class CountedValue
+{
+public:
+    static int alive;
+
+    CountedValue(int value = 0) : _value(new int(value))
+    {
+        ++alive;
+    }
+
+    CountedValue(const CountedValue& other) : _value(new int(*other._value))
+    {
+        ++alive;
+    }
+
+    CountedValue& operator=(const CountedValue& other)
+    {
+        *_value = *other._value;
+        return *this;
+    }
+
+    ~CountedValue()
+    {
+        delete _value;
+        --alive;
+    }
+
+    bool operator==(const CountedValue& other) const
+    {
+        return *_value == *other._value;
+    }
+
+    bool operator!=(const CountedValue& other) const
+    {
+        return !(*this == other);
+    }
+
+    int get() const
+    {
+        return *_value;
+    }
+
+private:
+    int* _value;
+};
+
+int CountedValue::alive = 0;
+
+TEST_CASE("HashMap with non trivially copyable values") {
+    // if your map uses a special storage for trivially copyable types(e.g memcpy, or skipping destructors), it must
+    // not be used for types like this one
+    REQUIRE(!std::is_trivially_copyable<CountedValue>::value);
+    {
+        HashMap<std::string, CountedValue> map;
+        for (int i = 0; i < 1000; ++i)
+        {
+            map["phrase " + std::to_string(i)] = CountedValue(i);
+        }
+        REQUIRE(map.at("phrase 500").get() == 500);
+        // if this fails, your map destroyed values that are still in it
+        REQUIRE(CountedValue::alive >= map.size());
+
+        for (int i = 0; i < 1000; i += 2)
+        {
+            REQUIRE(map.erase("phrase " + std::to_string(i)));
+        }
+        REQUIRE(map.at("phrase 501").get() == 501);
+
+        HashMap<std::string, CountedValue> copy(map);
+        REQUIRE(copy == map);
+        copy.at("phrase 501") = CountedValue(-1);
+        REQUIRE(map.at("phrase 501").get() == 501);
+
+        copy.clear();
+        REQUIRE(copy.empty());
+        REQUIRE(map.size() == 500);
+    }
+    // all maps were destroyed, so all of their values must have been destroyed as well
+    REQUIRE(CountedValue::alive == 0);
+}
+
 TEST_CASE("HashMap tests for large inputs") {
     SECTION("Behaves similarly to a std::unordered_map")
     {
@@ -259,6 +481,197 @@ TEST_CASE("HashMap tests for large inputs") {
             REQUIRE(stdMap[kvp.first] == kvp.second);
         }
     }
+
+    SECTION("Creating a hashmap from large key and value vectors is the same as inserting them one by one")
+    {
+        std::mt19937 rng(1337);
+        // a small key range relative to the number of keys, so most keys appear several times
+        std::uniform_int_distribution<int> intGen(0, 50000);
+
+        std::vector<int> intKeys, values;
+        std::vector<std::string> stringKeys;
+        for (int i = 0; i < 200000; ++i)
+        {
+            int key = intGen(rng);
+            intKeys.push_back(key);
+            stringKeys.push_back("phrase " + std::to_string(key));
+            values.push_back(i);
+        }
+
+        HashMap<int, int> intSequential;
+        HashMap<std::string, int> stringSequential;
+        for (size_t i = 0; i < intKeys.size(); ++i)
+        {
+            // like the small vectors test, a later occurrence of a key overwrites the former
+            intSequential[intKeys[i]] = values[i];
+            stringSequential[stringKeys[i]] = values[i];
+        }
+
+        const HashMap<int, int> intMap(intKeys, values);
+        const HashMap<std::string, int> stringMap(stringKeys, values);
+
+        REQUIRE(intMap.size() == intSequential.size());
+        REQUIRE(stringMap.size() == stringSequential.size());
+        // if this fails, the constructor probably kept the wrong value for a duplicate key
+        REQUIRE(intMap == intSequential);
+        REQUIRE(stringMap == stringSequential);
+        for (const auto& kvp: intSequential)
+        {
+            REQUIRE(intMap.at(kvp.first) == kvp.second);
+        }
+    }
+
+    SECTION("Many independent lookups of present and missing keys agree with std::unordered_map")
+    {
+        std::mt19937 rng(1337);
+        std::uniform_int_distribution<int> intGen(0, 200000);
+
+        std::unordered_map<int, int> stdMap;
+        HashMap<int, int> myMap;
+        for (int i = 0; i < 20000; ++i)
+        {
+            int key = intGen(rng);
+            stdMap[key] = i;
+            myMap[key] = i;
+        }
+
+        // roughly 10% of these keys are in the map, like phrases looked up in a message
+        std::vector<int> lookups;
+        for (int i = 0; i < 200000; ++i)
+        {
+            lookups.push_back(intGen(rng));
+        }
+
+        // checking all the lookups before reporting, a REQUIRE per lookup would dominate the running time
+        int hits = 0;
+        int firstMismatch = -1;
+        const HashMap<int, int>& constMap = myMap;
+        for (int key: lookups)
+        {
+            bool expected = stdMap.count(key) == 1;
+            if (constMap.containsKey(key) != expected || (expected && constMap.at(key) != stdMap.at(key)))
+            {
+                firstMismatch = key;
+                break;
+            }
+            hits += expected;
+        }
+        INFO("first mismatching key: " << firstMismatch);
+        REQUIRE(firstMismatch == -1);
+        // looking up keys never changes the map
+        REQUIRE(myMap.size() == stdMap.size());
+        REQUIRE(hits > 0);
+    }
+
+    SECTION("Equality of large maps doesn't depend on insertion order or capacity")
+    {
+        // multiples of 1024 collide in every table of up to 1024 buckets(with the common "hash modulo capacity"),
+        // and share a few long buckets in bigger tables, so the order of the entries within a bucket matters
+        std::vector<int> keys;
+        for (int i = 0; i < 10000; ++i)
+        {
+            keys.push_back(i * 1024);
+        }
+        std::vector<int> values(keys);
+
+        HashMap<int, int> ordered(keys, values);
+
+        std::vector<int> shuffledKeys(keys);
+        std::shuffle(shuffledKeys.begin(), shuffledKeys.end(), std::mt19937(1337));
+        HashMap<int, int> shuffled;
+        for (int key: shuffledKeys)
+        {
+            shuffled[key] = key;
+        }
+        REQUIRE(ordered == shuffled);
+        REQUIRE(!(ordered != shuffled));
+
+        // same entries, but this map grew much further and only shrank part of the way back, so its capacity differs
+        HashMap<int, int> resized(shuffled);
+        for (int i = 0; i < 40000; ++i)
+        {
+            resized[10000 * 1024 + i] = i;
+        }
+        for (int i = 0; i < 40000; ++i)
+        {
+            resized.erase(10000 * 1024 + i);
+        }
+        REQUIRE(resized.size() == ordered.size());
+        REQUIRE(resized.capacity() != ordered.capacity());
+        REQUIRE(ordered == resized);
+        REQUIRE(resized == ordered);
+
+        SECTION("A single different value makes large maps unequal")
+        {
+            shuffled[5432 * 1024] = -1;
+            REQUIRE(ordered != shuffled);
+            REQUIRE(shuffled != ordered);
+        }
+
+        SECTION("A single different key makes large maps of the same size unequal")
+        {
+            shuffled.erase(5432 * 1024);
+            shuffled[5432 * 1024 + 1] = 5432 * 1024;
+            REQUIRE(shuffled.size() == ordered.size());
+            REQUIRE(ordered != shuffled);
+            REQUIRE(shuffled != ordered);
+        }
+
+        SECTION("Maps of different sizes are unequal")
+        {
+            shuffled.erase(0);
+            REQUIRE(ordered != shuffled);
+            REQUIRE(shuffled != ordered);
+        }
+    }
+
+    SECTION("Copies of a large map are equal to and independent of the original")
+    {
+        HashMap<std::string, int> orig;
+        for (int i = 0; i < 100000; ++i)
+        {
+            orig["phrase " + std::to_string(i)] = i;
+        }
+        // erasing some entries, so the copy must skip the gaps they left
+        for (int i = 0; i < 100000; i += 3)
+        {
+            orig.erase("phrase " + std::to_string(i));
+        }
+
+        HashMap<std::string, int> copy(orig);
+        REQUIRE(copy == orig);
+
+        // the copy doesn't share storage with the original
+        copy["phrase 1"] = -1;
+        copy.erase("phrase 2");
+        REQUIRE(orig.at("phrase 1") == 1);
+        REQUIRE(orig.containsKey("phrase 2"));
+        orig.clear();
+        REQUIRE(copy.size() > 0);
+        REQUIRE(copy.at("phrase 4") == 4);
+
+        SECTION("Copy assignment")
+        {
+            HashMap<std::string, int> assigned;
+            assigned["not in copy"] = 1;
+            assigned = copy;
+            REQUIRE(assigned == copy);
+            REQUIRE(!assigned.containsKey("not in copy"));
+
+            // assigning a small map to a large one
+            HashMap<std::string, int> small({"a"}, {1});
+            assigned = small;
+            REQUIRE(assigned == small);
+            REQUIRE(assigned.size() == 1);
+
+            // self assignment doesn't change the map
+            assigned = assigned;
+            REQUIRE(assigned == small);
+
+            assigned["b"] = 2;
+            REQUIRE(!small.containsKey("b"));
+        }
+    }
 }
 
 TEST_CASE("HashMap iterator tests")
@@ -410,4 +823,257 @@ TEST_CASE("HashMap iterator tests")
         // both iterators that were advancedshould equal the end
 
     }
-}
\ No newline at end of file
+
+    SECTION("Iterator traits and the multi-pass guarantee of a Forward Iterator")
+    {
+        using Iterator = decltype(std::declval<const HashMap<std::string, int>&>().begin());
+        using Traits = std::iterator_traits<Iterator>;
+
+        // these are checked at compile time, if one of them fails your iterator doesn't define the nested types STL
+        // algorithms expect(iterator_category, value_type, difference_type, pointer, reference)
+        static_assert(std::is_base_of<std::forward_iterator_tag, typename Traits::iterator_category>::value,
+                      "The iterator should be (at least) a Forward Iterator");
+        static_assert(std::is_same<typename Traits::value_type, std::pair<std::string, int>>::value,
+                      "The iterator's value_type should be std::pair<KeyT, ValueT>");
+        // the reference doesn't have to be an actual 'const std::pair&'(e.g, if keys and values are stored in
+        // separate arrays), but it must be usable as one
+        static_assert(std::is_convertible<typename Traits::reference, const std::pair<std::string, int>&>::value,
+                      "Dereferencing the iterator should give something usable as a const std::pair<KeyT, ValueT>&");
+
+        const HashMap<std::string, int> map({"a", "b", "c", "d"}, {1, 2, 3, 4});
+
+        // a forward iterator can be copied, and both copies traverse the same sequence independently
+        std::vector<std::pair<std::string, int>> firstPass, secondPass;
+        auto it = map.begin();
+        auto saved = it;
+        for (; it != map.end(); ++it)
+        {
+            firstPass.emplace_back(it->first, it->second);
+        }
+        for (; saved != map.end(); saved++)
+        {
+            const std::pair<std::string, int>& kvp = *saved;
+            secondPass.push_back(kvp);
+        }
+        REQUIRE(firstPass.size() == 4);
+        REQUIRE(firstPass == secondPass);
+    }
+
+    SECTION("Can iterate over a large hashmap after most of its elements were erased")
+    {
+        HashMap<int, int> myMap;
+        for (int i = 0; i < 100000; ++i)
+        {
+            myMap[i] = i;
+        }
+
+        // erasing all but every 100th key, the remaining keys are spread over the entire table
+        std::vector<std::pair<int, int>> remaining;
+        int erased = 0;
+        for (int i = 0; i < 100000; ++i)
+        {
+            if (i % 100 == 0)
+            {
+                remaining.emplace_back(i, i);
+            }
+            else
+            {
+                erased += myMap.erase(i);
+            }
+        }
+        REQUIRE(erased == 100000 - (int) remaining.size());
+        REQUIRE(myMap.size() == (int) remaining.size());
+
+        const HashMap<int, int>& constMap = myMap;
+        int iters = 0;
+        for (const std::pair<int, int>& kvp: constMap)
+        {
+            ++iters;
+            REQUIRE(kvp.first % 100 == 0);
+            REQUIRE(kvp.first == kvp.second);
+        }
+        // if this fails, your iterator skipped over(or repeated) some of the remaining elements
+        REQUIRE(iters == constMap.size());
+
+        long keySum = std::accumulate(constMap.begin(), constMap.end(), 0L,
+                                      [](long sum, const std::pair<int, int>& kvp) -> long {
+                                          return sum + kvp.first;
+                                      });
+        REQUIRE(keySum == 999L * 1000 * 100 / 2);
+        REQUIRE(std::is_permutation(constMap.begin(), constMap.end(), remaining.cbegin()));
+
+        // erasing the rest, begin() must then equal end()
+        erased = 0;
+        for (const auto& kvp: remaining)
+        {
+            erased += myMap.erase(kvp.first);
+        }
+        REQUIRE(erased == (int) remaining.size());
+        REQUIRE(myMap.empty());
+        REQUIRE(constMap.begin() == constMap.end());
+    }
+}
+
+TEST_CASE("Parallel reduction over a const HashMap")
+{
+    SECTION("Reducing sub-ranges on several threads gives the same result as std::accumulate")
+    {
+        HashMap<int, int> myMap;
+        std::mt19937 rng(1337);
+        std::uniform_int_distribution<int> intGen(1, 1000);
+        for (int i = 0; i < 100000; ++i)
+        {
+            myMap[i] = intGen(rng);
+        }
+        const HashMap<int, int>& constMap = myMap;
+
+        auto addValue = [](long sum, const std::pair<int, int>& kvp) -> long {
+            return sum + kvp.second;
+        };
+        long expectedSum = std::accumulate(constMap.begin(), constMap.end(), 0L, addValue);
+        // a reduction whose identity isn't T(), since every value is above 0
+        auto minValue = [](int min, const std::pair<int, int>& kvp) {
+            return std::min(min, kvp.second);
+        };
+        int expectedMin = std::accumulate(constMap.begin(), constMap.end(), INT_MAX, minValue);
+
+        // const methods may be called concurrently, so reading the map from several threads must be safe(if this
+        // crashes or is flaky, one of your const methods probably mutates shared state)
+        for (int threadCount: {1, 2, 3, 8})
+        {
+            INFO("threads: " << threadCount);
+            REQUIRE(parallelAccumulate(constMap, threadCount, 0L, addValue, std::plus<long>()) == expectedSum);
+            REQUIRE(parallelAccumulate(constMap, threadCount, INT_MAX, minValue,
+                                       [](int a, int b) { return std::min(a, b); }) == expectedMin);
+        }
+    }
+}
+
+TEST_CASE("HashMap bucket statistics")
+{
+    SECTION("Bucket statistics are consistent with the map's size and capacity")
+    {
+        HashMap<int, int> myMap;
+        std::vector<int> keys;
+        for (int i = 0; i < 10000; ++i)
+        {
+            keys.push_back(i);
+        }
+        int resizes = 0;
+        std::chrono::duration<double, std::milli> rehashTime(0);
+        insertTrackingResizes(myMap, keys, resizes, rehashTime);
+
+        BucketStats stats = collectBucketStats(myMap);
+        INFO(stats);
+
+        // every key is in exactly one bucket, and every bucket is either empty or occupied
+        int entries = 0, buckets = 0;
+        for (const auto& entry: stats.histogram)
+        {
+            entries += entry.first * entry.second;
+            buckets += entry.second;
+        }
+        REQUIRE(entries == myMap.size());
+        REQUIRE(buckets == myMap.capacity());
+
+        // 10000 entries can't fit in 16 buckets without resizing
+        REQUIRE(resizes > 0);
+        // if this fails, your load factor isn't kept below the upper bound
+        REQUIRE(stats.loadFactor <= 0.75);
+        // consecutive integers should spread nicely over the buckets, if this fails your hash function or bucket
+        // index calculation is probably very poor(e.g, most keys end up in the same bucket)
+        REQUIRE(stats.maxChainLength <= 8);
+    }
+
+    SECTION("Entries can be partitioned by bucket, consistently with bucketIndex and bucketSize")
+    {
+        HashMap<std::string, int> myMap;
+        for (int i = 0; i < 5000; ++i)
+        {
+            myMap["phrase " + std::to_string(i)] = i;
+        }
+
+        // grouping the entries by their bucket, as a tool processing individual buckets would
+        std::map<int, std::vector<std::string>> buckets;
+        for (const auto& kvp: myMap)
+        {
+            int index = myMap.bucketIndex(kvp.first);
+            REQUIRE(index >= 0);
+            REQUIRE(index < myMap.capacity());
+            buckets[index].push_back(kvp.first);
+        }
+
+        for (const auto& bucket: buckets)
+        {
+            for (const std::string& key: bucket.second)
+            {
+                // if this fails, bucketSize doesn't count the same entries your iterator visits in that bucket
+                REQUIRE(myMap.bucketSize(key) == (int) bucket.second.size());
+            }
+        }
+    }
+
+    SECTION("Erasing shrinks the table, so iterating costs time proportional to the size rather than the capacity")
+    {
+        HashMap<int, int> myMap;
+        for (int i = 0; i < 1 << 16; ++i)
+        {
+            myMap[i] = i;
+        }
+        int fullCapacity = myMap.capacity();
+
+        // leaving 100 live entries
+        int erased = 0;
+        double minLoadFactor = myMap.getLoadFactor();
+        for (int i = 100; i < 1 << 16; ++i)
+        {
+            erased += myMap.erase(i);
+            minLoadFactor = std::min(minLoadFactor, myMap.getLoadFactor());
+        }
+        REQUIRE(erased == (1 << 16) - 100);
+        // if this fails, you don't resize down when the load factor drops below the lower bound
+        REQUIRE(minLoadFactor >= 0.25);
+        REQUIRE(myMap.size() == 100);
+        REQUIRE(myMap.capacity() < fullCapacity);
+        // at most 4 buckets per live entry need to be scanned by begin() and operator++
+        REQUIRE(myMap.capacity() <= 4 * myMap.size());
+    }
+}
+
+// Not ran by default(hidden via the '.' tag), run it explicitly with "test_hashmap [stats]" to print the statistics of
+// your map for several key distributions.
+TEST_CASE("Print HashMap bucket statistics", "[.][stats]")
+{
+    std::mt19937 rng(1337);
+    std::uniform_int_distribution<int> intGen(0, 100000000);
+
+    std::vector<int> sequentialKeys, randomKeys, strideKeys;
+    std::vector<std::string> stringKeys;
+    for (int i = 0; i < 1000000; ++i)
+    {
+        sequentialKeys.push_back(i);
+        randomKeys.push_back(intGen(rng));
+        // a stride that's a power of 2 is the worst case for "hash modulo capacity"
+        strideKeys.push_back(i * 1024);
+        stringKeys.push_back("phrase " + std::to_string(intGen(rng)));
+    }
+
+    // inserts the keys into an empty map and prints its statistics
+    auto report = [](const std::string& label, const auto& keys) {
+        using KeyT = typename std::decay<decltype(keys)>::type::value_type;
+        HashMap<KeyT, int> myMap;
+        int resizes = 0;
+        std::chrono::duration<double, std::milli> rehashTime(0);
+        insertTrackingResizes(myMap, keys, resizes, rehashTime);
+
+        std::ostringstream out;
+        out << label << ": " << collectBucketStats(myMap) << "\nresizes=" << resizes
+            << " rehashTime=" << rehashTime.count() << "ms";
+        WARN(out.str());
+    };
+
+    report("sequential int keys", sequentialKeys);
+    report("random int keys", randomKeys);
+    report("int keys with a stride of 1024", strideKeys);
+    report("string keys", stringKeys);
+}
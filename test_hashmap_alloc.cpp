@@ -0,0 +1,218 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "../HashMap.hpp"
+#include <numeric>
+
+/*
+ * These tests check how many times your HashMap allocates memory, rather than its behavior. The global operator
+ * new/delete are replaced by versions counting the allocations(in counting_allocator.cpp), so any allocation made by
+ * your map(directly, or indirectly e.g via std::vector or std::string) is counted. The last test checks that copies
+ * clone the table of the original, rather than rebuilding it entry by entry.
+ *
+ * Note that a failure here doesn't necessarily mean your map is incorrect, but that it does unnecessary work on a hot
+ * path, such as copying a bucket or a key during a lookup.
+ */
+
+// the number of allocations made so far, counted by the operator new defined in counting_allocator.cpp
+extern long allocationCount;
+
+/**
+ * Counts the allocations made from its construction until count() is called.
+ * (REQUIRE may allocate as well, so only call it after reading the count)
+ */
+class AllocationCounter
+{
+public:
+    AllocationCounter() : _start(allocationCount)
+    {
+    }
+
+    long count() const
+    {
+        return allocationCount - _start;
+    }
+
+private:
+    long _start;
+};
+
+TEST_CASE("Lookups don't allocate")
+{
+    HashMap<int, int> intMap;
+    HashMap<std::string, int> stringMap;
+    std::vector<std::string> stringKeys;
+    for (int i = 0; i < 10000; ++i)
+    {
+        intMap[i] = i;
+        // long enough to not fit in the small string optimization, so copying such a key allocates
+        stringKeys.push_back("a rather long phrase number " + std::to_string(i));
+        stringMap[stringKeys.back()] = i;
+    }
+    const HashMap<int, int>& constIntMap = intMap;
+    const HashMap<std::string, int>& constStringMap = stringMap;
+
+    SECTION("Looking up existing keys")
+    {
+        long sum = 0;
+        AllocationCounter counter;
+        for (int i = 0; i < 10000; ++i)
+        {
+            sum += constIntMap.at(i) + constIntMap[i] + intMap.at(i) + intMap[i] + constIntMap.containsKey(i);
+            sum += constStringMap.at(stringKeys[i]) + stringMap[stringKeys[i]] + constStringMap.containsKey(stringKeys[i]);
+        }
+        long allocations = counter.count();
+        REQUIRE(sum > 0);
+        // if this fails, you probably copy keys, values or buckets when looking up a key(e.g, taking them by value, or
+        // iterating a bucket with 'auto' instead of 'const auto&')
+        REQUIRE(allocations == 0);
+    }
+
+    SECTION("Looking up missing keys")
+    {
+        int found = 0;
+        std::string missing = "a rather long phrase which isn't in the map";
+        AllocationCounter counter;
+        for (int i = 10000; i < 20000; ++i)
+        {
+            found += constIntMap.containsKey(i) + constStringMap.containsKey(missing);
+        }
+        long allocations = counter.count();
+        REQUIRE(found == 0);
+        REQUIRE(allocations == 0);
+    }
+
+    SECTION("containsKey with a string literal(heterogeneous key)")
+    {
+        // the literal is converted to a std::string, but a short one fits in the small string optimization, so
+        // nothing but your map can allocate here
+        int found = 0;
+        AllocationCounter counter;
+        for (int i = 0; i < 10000; ++i)
+        {
+            found += constStringMap.containsKey("short key");
+        }
+        long allocations = counter.count();
+        REQUIRE(found == 0);
+        REQUIRE(allocations == 0);
+    }
+}
+
+TEST_CASE("Iteration doesn't allocate")
+{
+    HashMap<int, int> myMap;
+    for (int i = 0; i < 10000; ++i)
+    {
+        myMap[i] = i;
+    }
+    const HashMap<int, int>& constMap = myMap;
+
+    long sum = 0;
+    AllocationCounter counter;
+    for (const std::pair<int, int>& kvp: constMap)
+    {
+        sum += kvp.second;
+    }
+    sum += std::accumulate(constMap.begin(), constMap.end(), 0L,
+                           [](long acc, const std::pair<int, int>& kvp) { return acc + kvp.first; });
+    auto it = constMap.cbegin();
+    auto copy = it;
+    ++it;
+    copy++;
+    sum += it == copy;
+    long allocations = counter.count();
+
+    REQUIRE(sum == 2L * 9999 * 10000 / 2 + 1);
+    // if this fails, your iterator probably copies pairs or buckets, or your begin()/end() copy the map
+    REQUIRE(allocations == 0);
+}
+
+TEST_CASE("Updates allocate a bounded amount")
+{
+    SECTION("Overwriting existing values doesn't allocate")
+    {
+        HashMap<int, int> myMap;
+        for (int i = 0; i < 10000; ++i)
+        {
+            myMap[i] = i;
+        }
+
+        AllocationCounter counter;
+        for (int i = 0; i < 10000; ++i)
+        {
+            myMap[i] = -i;
+            myMap.at(i) += 1;
+        }
+        long allocations = counter.count();
+        REQUIRE(myMap.at(5) == -4);
+        REQUIRE(allocations == 0);
+    }
+
+    SECTION("Inserting n elements makes O(n) allocations in total, including resizes")
+    {
+        const int n = 100000;
+        HashMap<int, int> myMap;
+        AllocationCounter counter;
+        for (int i = 0; i < n; ++i)
+        {
+            myMap[i] = i;
+        }
+        long allocations = counter.count();
+        REQUIRE(myMap.size() == n);
+        INFO("allocations: " << allocations);
+        // a constant number of allocations per element, amortized over the resizes(each resize allocates a new table,
+        // and possibly the buckets in it). If this fails, you probably copy the entire table too often.
+        REQUIRE(allocations <= 8L * n);
+    }
+
+    SECTION("Erasing without resizing doesn't allocate")
+    {
+        HashMap<int, int> myMap;
+        for (int i = 0; i < 1000; ++i)
+        {
+            myMap[i] = i;
+        }
+        int capacity = myMap.capacity();
+
+        int erased = 0;
+        AllocationCounter counter;
+        // erasing a few elements keeps the load factor above the lower bound
+        for (int i = 0; i < 10; ++i)
+        {
+            erased += myMap.erase(i);
+        }
+        long allocations = counter.count();
+        REQUIRE(erased == 10);
+        REQUIRE(myMap.capacity() == capacity);
+        REQUIRE(allocations == 0);
+    }
+}
+
+TEST_CASE("Copies clone the table of the original")
+{
+    HashMap<std::string, int> orig;
+    for (int i = 0; i < 100000; ++i)
+    {
+        orig["phrase " + std::to_string(i)] = i;
+    }
+    // shrinking it a bit, so its capacity isn't what inserting its current entries into an empty map would give
+    for (int i = 0; i < 100000; i += 3)
+    {
+        orig.erase("phrase " + std::to_string(i));
+    }
+
+    // if these fail, your copy constructor/assignment probably inserts the entries one by one(rehashing every key and
+    // resizing along the way) instead of copying the table as is, including its capacity
+    SECTION("Copy constructor")
+    {
+        HashMap<std::string, int> copy(orig);
+        REQUIRE(copy.capacity() == orig.capacity());
+    }
+
+    SECTION("Copy assignment")
+    {
+        HashMap<std::string, int> assigned;
+        assigned["not in orig"] = 1;
+        assigned = orig;
+        REQUIRE(assigned.capacity() == orig.capacity());
+    }
+}
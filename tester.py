@@ -7,9 +7,19 @@ import pytest
 import subprocess
 from typing import List, Union
 from tempfile import NamedTemporaryFile
+from statistics import median
+from bench import generate_db, generate_message, measure, parse_size
 
 USE_VALGRIND = True
 
+# the performance tests run each case several times(without valgrind), and fail if your executable's median wall time
+# or peak RSS is more than the given factor of the school's. These can be overridden via environment variables.
+PERF_REPEATS = int(os.environ.get("PERF_REPEATS", 3))
+MAX_SLOWDOWN = float(os.environ.get("MAX_SLOWDOWN", 2.0))
+MAX_MEMORY_RATIO = float(os.environ.get("MAX_MEMORY_RATIO", 2.0))
+# runs shorter than this(in seconds) are dominated by noise, so the slowdown is only checked above it
+MIN_MEASURED_TIME = 0.05
+
 TEST_DIR = Path(__file__).parent
 
 EXECUTABLE_PATH = Path(Path(TEST_DIR) / "../cmake-build-debug/SpamDetector")
@@ -88,6 +98,49 @@ TEST_CASES = [
     ("Wrong structure", "invalid/wrong_structure3.db", "email-text", 50),
     ("Empty row(newline)", "invalid/empty_row.db", "email-text", 50),
     ("Empty row(spaces)", "invalid/empty_row_spaces.db", "email-text", 50),
+    ("Empty row at the beginning", "invalid/leading_empty_row.db", "email-text", 50),
+    ("Empty row at the end(file ends with two newlines)", "invalid/trailing_empty_row.db", "email-text", 50),
+    ("Windows line endings(CRLF)", "invalid/crlf.db", "email-text", 50),
+    # same DB as valid/00.db, without a newline after the last row
+    ("Last row without a trailing newline", "valid/03.db", "email-text", 145),
+    ("Last row without a trailing newline", "valid/03.db", "email-text", 146),
+    ("Empty DB file", "valid/04.db", "email-text", 1),
+    # the following DBs are valid/00.db with the 'unsuccessful,30' row altered
+    ("Spaces around the comma", "invalid/spaces_around_comma.db", "email-text", 50),
+    ("Trailing space after the score", "invalid/trailing_space.db", "email-text", 50),
+    ("Trailing comma", "invalid/trailing_comma.db", "email-text", 50),
+    ("Empty score", "invalid/empty_score.db", "email-text", 50),
+    ("Empty phrase", "invalid/empty_phrase.db", "email-text", 50),
+    ("Negative score", "invalid/negative_score.db", "email-text", 50),
+    ("Score with a plus sign", "invalid/plus_sign_score.db", "email-text", 50),
+    ("Score with a leading zero", "invalid/leading_zero_score.db", "email-text", 50),
+    ("Non integer score(decimal point)", "invalid/float_score.db", "email-text", 50),
+    ("Non integer score(exponent)", "invalid/exponent_score.db", "email-text", 50),
+    ("Score that doesn't fit in an int", "invalid/overflowing_score.db", "email-text", 50),
+    # the score for the text is 25. valid/00.db with the phrase ' country'(leading space), which isn't trimmed: it only
+    # matches the 2 occurrences of "country" after a space, not the 3 at the start of a line or after punctuation
+    # (trimming it would give a score of 40)
+    ("Phrase with a leading space", "valid/05.db", "leading-space-text", 25),
+    ("Phrase with a leading space", "valid/05.db", "leading-space-text", 26),
+    # the score for the text is 695. The DB has 4001 rows: 1000 phrases repeat 3001 rows after their first occurrence,
+    # and 'w1500x' repeats on the very next row, each time with a different score - only the first occurrence counts
+    ("Duplicate phrases, first occurrence wins", "valid/06.db", "duplicates-text", 695),
+    ("Duplicate phrases, first occurrence wins", "valid/06.db", "duplicates-text", 696),
+    # the score for the text is 98. Phrases are matched as case-insensitive substrings rather than whole words
+    # ("work" inside "homework", "china" inside "chinaa"), occurrences don't overlap ("aaaa" contains "aa" twice) and
+    # whitespace isn't normalized ("working    with" and "working\nwith" don't contain "working with")
+    ("Substring (not word based) phrase matching", "valid/01.db", "substring-text", 97),
+    ("Substring (not word based) phrase matching", "valid/01.db", "substring-text", 98),
+    ("Substring (not word based) phrase matching", "valid/01.db", "substring-text", 99),
+    # the score for the text is 1519. Phrases straddle 16/32/64 byte boundaries, the DB has phrases longer than 32
+    # bytes and near-misses that share the first and last byte of a phrase("abxd" for "abcd"), and the text ends with
+    # a phrase without a trailing newline
+    ("Phrases across block boundaries of a long text", "valid/02.db", "boundaries-text", 1518),
+    ("Phrases across block boundaries of a long text", "valid/02.db", "boundaries-text", 1519),
+    ("Phrases across block boundaries of a long text", "valid/02.db", "boundaries-text", 1520),
+    # the score for the text is 8, it is shorter than some of the phrases
+    ("A text shorter than some phrases", "valid/02.db", "short-text", 8),
+    ("A text shorter than some phrases", "valid/02.db", "short-text", 9),
 
 ]
 
@@ -101,6 +154,51 @@ def test(label: str, csv_path: str, txt_path: str, threshold: Union[str, int]):
     if USE_VALGRIND:
         my_out.check_valgrind_out()
 
+PERF_CASES = [
+    # (number of DB phrases, message size, rate of phrases in the message)
+    (1000, "1M", 0.01),
+    (10000, "256K", 0.01),
+    (100, "8M", 0.05),
+]
+
+
+@pytest.fixture(scope="module")
+def perf_dir(tmp_path_factory):
+    return tmp_path_factory.mktemp("perf")
+
+
+@pytest.mark.parametrize("db_size,message_size,hit_rate", PERF_CASES)
+def test_performance(perf_dir: Path, db_size: int, message_size: str, hit_rate: float):
+    db_path = perf_dir / f"{db_size}.db"
+    message_path = perf_dir / f"{db_size}_{message_size}_{hit_rate}.txt"
+    phrases = generate_db(db_path, db_size)
+    generate_message(message_path, parse_size(message_size), phrases, hit_rate)
+
+    args = [str(db_path), str(message_path), "1000"]
+    mine = [measure([str(EXECUTABLE_PATH)] + args) for _ in range(PERF_REPEATS)]
+    school = [measure([str(SCHOOL_EXECUTABLE)] + args) for _ in range(PERF_REPEATS)]
+
+    Output(school[0].return_code, school[0].stdout, school[0].stderr, "").compare_to(
+        Output(mine[0].return_code, mine[0].stdout, mine[0].stderr, ""))
+
+    my_time, school_time = median(m.wall_time for m in mine), median(m.wall_time for m in school)
+    # runs which exited before their memory could be sampled have an unknown peak RSS(None), and are left out
+    my_rss = max((m.max_rss for m in mine if m.max_rss is not None), default=None)
+    school_rss = max((m.max_rss for m in school if m.max_rss is not None), default=None)
+    print(f"DB of {db_size} phrases, message of {message_size}: "
+          f"yours: wall={my_time:.3f}s cpu={median(m.cpu_time for m in mine):.3f}s maxRSS={my_rss}KB, "
+          f"school: wall={school_time:.3f}s cpu={median(m.cpu_time for m in school):.3f}s maxRSS={school_rss}KB")
+
+    if my_time > MIN_MEASURED_TIME:
+        assert my_time <= MAX_SLOWDOWN * school_time, \
+            f"Your executable is {my_time / school_time:.2f}x slower than the school's(max allowed: {MAX_SLOWDOWN}x)"
+    if my_rss is None or school_rss is None:
+        print("Couldn't measure the peak memory of both executables, skipping the memory check")
+        return
+    assert my_rss <= MAX_MEMORY_RATIO * school_rss, \
+        f"Your executable uses {my_rss / school_rss:.2f}x the memory of the school's(max allowed: {MAX_MEMORY_RATIO}x)"
+
+
 if __name__ == '__main__':
     exit_code = pytest.main([__file__, '-vvs'])
     sys.exit(exit_code)